@@ -0,0 +1,60 @@
+// On-target benchmark: measures the cycles/op of each routine in bench_routines
+// with TCB0 counting CLK_PER, then prints the results over UART as CSV lines
+// that bench_host reads with -a.
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "initialisation.h"
+#include "uart.h"
+
+#define AVR_CALLS 8 // Wrapper calls per routine, each timed on its own so TCB0 cannot wrap.
+
+// Function: measure
+// Description: Counts the CPU cycles per routine call, including the wrapper's
+//              loop and store, which is the same for every routine.
+// Parameters:
+//  - run: Wrapper that calls the routine BENCH_INNER times
+static uint16_t measure(void (*run)(uint8_t))
+{
+    uint32_t total = 0;
+
+    for (uint8_t i = 0; i < AVR_CALLS; i++)
+    {
+        TCB0.CNT = 0;
+        uint16_t start = TCB0.CNT;
+        run(i);
+        total += (uint16_t)(TCB0.CNT - start);
+    }
+
+    return total / ((uint16_t)AVR_CALLS * BENCH_INNER);
+}
+
+int main(void)
+{
+    cli(); // Interrupts stay off so no ISR time is counted.
+    uart_init();
+
+    // TCB0 free-runs at CLK_PER, which is also the CPU clock.
+    TCB0.CCMP = 0xFFFF;
+    TCB0.CTRLB = TCB_CNTMODE_INT_gc;
+    TCB0.CTRLA = TCB_CLKSEL_DIV1_gc | TCB_ENABLE_bm;
+
+    char number[6];
+
+    uart_puts("routine,target,value,unit\n");
+    for (uint8_t i = 0; i < bench_routine_count; i++)
+    {
+        uart_puts((char *)bench_routines[i].name);
+        uart_puts(",avr,");
+        uart_puts(utoa(measure(bench_routines[i].run), number, 10));
+        uart_puts(",cycles/op\n");
+    }
+
+    while (1)
+    {
+    } // Results are printed once per reset.
+}
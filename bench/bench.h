@@ -0,0 +1,17 @@
+#include <stdint.h>
+
+#define BENCH_INNER 32 // Routine calls per wrapper call, so the call overhead is amortised.
+
+// Struct containing a benchmarked routine and the wrapper that calls it BENCH_INNER times.
+typedef struct bench_routine
+{
+    const char *name;
+    void (*run)(uint8_t i);
+} bench_routine;
+
+extern const bench_routine bench_routines[];
+extern const uint8_t bench_routine_count;
+extern volatile uint16_t bench_sink;
+
+void bench_reference(uint8_t i);
+void bench_pb_debounce(uint8_t i);
@@ -0,0 +1,106 @@
+#include "bench.h"
+
+#include <stdint.h>
+
+#include "buzzer.h"
+#include "display.h"
+#include "input.h"
+#include "sequence.h"
+#include "timer.h"
+
+// Results are stored here so the calls cannot be optimised away.
+volatile uint16_t bench_sink;
+
+// Function: reference_op
+// Description: Small out-of-line routine used as the unit of work for bench_reference.
+__attribute__((noinline)) static uint32_t reference_op(uint32_t x)
+{
+    return (x << 3) ^ (x >> 5) ^ 0x9E3779B9u;
+}
+
+// Function: bench_reference
+// Description: Calls a fixed out-of-line routine in the same loop as the other
+//              wrappers. Results are normalised against it so the baseline
+//              does not depend on the machine.
+void bench_reference(uint8_t i)
+{
+    uint32_t x = i;
+
+    for (uint8_t j = 0; j < BENCH_INNER; j++)
+    {
+        x = reference_op(x);
+        bench_sink = x;
+    }
+}
+
+static void bench_lsfr(uint8_t i)
+{
+    static uint32_t state = 0x11592931;
+    uint8_t step;
+    uint8_t result;
+
+    for (uint8_t j = 0; j < BENCH_INNER; j++)
+    {
+        LSFR(&state, &step, &result);
+        bench_sink = step + i;
+    }
+}
+
+static void bench_check_edge(uint8_t i)
+{
+    for (uint8_t j = 0; j < BENCH_INNER; j++)
+    {
+        pb_debounced_state = ((uint8_t)(i + j) & 0x04) ? 0xFF : 0x0F; // Edges every 4 calls.
+        check_edge();
+        bench_sink = pb_falling | pb_rising;
+    }
+}
+
+static void bench_extract_digits(uint8_t i)
+{
+    uint8_t left;
+    uint8_t right;
+
+    for (uint8_t j = 0; j < BENCH_INNER; j++)
+    {
+        extract_digits((uint8_t)(i + j) & 0x3F, &left, &right); // Scores 0 to 63.
+        bench_sink = left + right;
+    }
+}
+
+static void bench_display_segment(uint8_t i)
+{
+    for (uint8_t j = 0; j < BENCH_INNER; j++)
+    {
+        display_segment((uint8_t)(i + j) % 5); // Includes the display off pattern.
+        bench_sink = j;
+    }
+}
+
+static void bench_buzzer_period(uint8_t i)
+{
+    for (uint8_t j = 0; j < BENCH_INNER; j++)
+    {
+        bench_sink = buzzer_period((i + j) & 0b11);
+    }
+}
+
+static void bench_playback_delay_from_adc(uint8_t i)
+{
+    for (uint8_t j = 0; j < BENCH_INNER; j++)
+    {
+        bench_sink = playback_delay_from_adc(i + j);
+    }
+}
+
+const bench_routine bench_routines[] = {
+    {"LSFR", bench_lsfr},
+    {"pb_debounce", bench_pb_debounce},
+    {"check_edge", bench_check_edge},
+    {"extract_digits", bench_extract_digits},
+    {"display_segment", bench_display_segment},
+    {"buzzer_period", bench_buzzer_period},
+    {"playback_delay_from_adc", bench_playback_delay_from_adc},
+};
+
+const uint8_t bench_routine_count = sizeof(bench_routines) / sizeof(bench_routines[0]);
@@ -0,0 +1,8 @@
+// Host stand-in for <avr/interrupt.h>: ISRs become plain functions.
+#pragma once
+
+#include <avr/io.h>
+
+#define ISR(vector) void vector(void)
+#define cli()
+#define sei()
@@ -0,0 +1,57 @@
+// Host stand-in for <avr/io.h>: only the registers and bitmasks used by the
+// benchmarked sources, backed by plain variables in registers.c.
+#pragma once
+
+#include <stdint.h>
+
+typedef struct
+{
+    volatile uint8_t IN;
+    volatile uint8_t OUTSET;
+    volatile uint8_t OUTCLR;
+} PORT_t;
+
+typedef struct
+{
+    struct
+    {
+        volatile uint16_t PERBUF;
+        volatile uint16_t CMP0BUF;
+    } SINGLE;
+} TCA_t;
+
+typedef struct
+{
+    volatile uint8_t COMMAND;
+    volatile uint8_t INTFLAGS;
+    volatile uint8_t RESULT;
+} ADC_t;
+
+typedef struct
+{
+    volatile uint8_t DATA;
+    volatile uint8_t INTFLAGS;
+} SPI_t;
+
+typedef struct
+{
+    volatile uint8_t INTFLAGS;
+} TCB_t;
+
+extern PORT_t PORTA;
+extern TCA_t TCA0;
+extern ADC_t ADC0;
+extern SPI_t SPI0;
+extern TCB_t TCB0;
+extern TCB_t TCB1;
+
+#define PIN1_bm 0x02
+#define PIN4_bm 0x10
+#define PIN5_bm 0x20
+#define PIN6_bm 0x40
+#define PIN7_bm 0x80
+
+#define ADC_START_IMMEDIATE_gc 0x01
+#define ADC_RESRDY_bm 0x01
+#define SPI_IF_bm 0x80
+#define TCB_CAPT_bm 0x01
@@ -0,0 +1,420 @@
+// Host benchmark: times each routine in bench_routines, adds any AVR cycles/op
+// captured from bench_avr, writes the results as CSV and compares them against
+// a baseline. Exits non-zero if any routine regressed past its threshold or has
+// no baseline entry.
+//
+// Host routines are reported twice: "host_ns" is the raw ns/op for information,
+// and "host" is the time relative to bench_reference (a fixed out-of-line
+// shift/xor), which is what the baseline gates on since it carries across
+// machines. Both are medians over several rounds, each round timing every
+// routine once, so slow drifts in machine load spread over all routines.
+//
+// With -w the baseline is written from the median of the rounds, and each
+// host threshold is set from the spread seen across those rounds. Timings also
+// shift between processes, so 'make baseline' instead records several separate
+// runs and passes their result files to -w, which then aggregates those.
+//
+// Usage: bench_host [-o results.csv] [-b baseline.csv] [-a avr_log] [-r rounds]
+//                   [-w [results.csv...]]
+
+#define _GNU_SOURCE
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "bench.h"
+
+#define HOST_CALLS 20000u // Wrapper calls per timing, each running BENCH_INNER ops.
+#define HOST_REPEATS 21   // Timings per routine in one round.
+#define MAX_ROUNDS 64
+#define MAX_RESULTS 32
+#define MIN_THRESHOLD_PCT 10 // Floor for host thresholds derived from the spread.
+#define AVR_THRESHOLD_PCT 5  // Cycle counts only change when the code does.
+
+// Struct containing one measured value, as stored in the results and baseline files.
+typedef struct result
+{
+    char routine[32];
+    char target[8];
+    double value;
+    double threshold_pct;
+} result;
+
+static result results[MAX_RESULTS];
+static uint8_t result_count = 0;
+
+// Function: now_ns
+// Description: Returns the monotonic clock in nanoseconds.
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+// Function: time_calls
+// Description: Times HOST_CALLS wrapper calls, in ns per routine call.
+// Parameters:
+//  - run: Wrapper that calls the routine BENCH_INNER times
+static double time_calls(void (*run)(uint8_t))
+{
+    uint64_t start = now_ns();
+    for (uint32_t i = 0; i < HOST_CALLS; i++)
+    {
+        run((uint8_t)i);
+    }
+    return (double)(now_ns() - start) / ((double)HOST_CALLS * BENCH_INNER);
+}
+
+// Function: compare_doubles
+// Description: qsort comparator for doubles.
+static int compare_doubles(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Function: median
+// Description: Sorts values in place and returns their median.
+static double median(double *values, uint8_t count)
+{
+    qsort(values, count, sizeof(double), compare_doubles);
+    return values[count / 2];
+}
+
+// Function: measure
+// Description: Times a routine in back-to-back pairs with bench_reference, so
+//              both halves of a pair see the same machine load, and takes the
+//              median of each.
+// Parameters:
+//  - run: Wrapper that calls the routine BENCH_INNER times
+//  - ns: Pointer to store the median ns per routine call
+//  - ratio: Pointer to store the median time relative to bench_reference
+static void measure(void (*run)(uint8_t), double *ns, double *ratio)
+{
+    double times[HOST_REPEATS];
+    double ratios[HOST_REPEATS];
+
+    for (uint8_t repeat = 0; repeat < HOST_REPEATS; repeat++)
+    {
+        double reference = time_calls(bench_reference);
+        times[repeat] = time_calls(run);
+        ratios[repeat] = times[repeat] / reference;
+    }
+
+    *ns = median(times, HOST_REPEATS);
+    *ratio = median(ratios, HOST_REPEATS);
+}
+
+// Function: threshold_from_spread
+// Description: Returns twice the worst excursion above the median, as a
+//              percentage, with a floor of MIN_THRESHOLD_PCT.
+// Parameters:
+//  - values: Sorted samples
+//  - count: Number of samples
+static double threshold_from_spread(const double *values, uint8_t count)
+{
+    double middle = values[count / 2];
+    double threshold_pct = ceil(200 * (values[count - 1] - middle) / middle);
+    return (threshold_pct < MIN_THRESHOLD_PCT) ? MIN_THRESHOLD_PCT : threshold_pct;
+}
+
+// Function: read_runs
+// Description: Collects the "host" value of a routine from earlier result files.
+// Parameters:
+//  - paths: Result files written by separate runs
+//  - count: Number of files
+//  - routine: Routine to collect
+//  - values: Array of at least MAX_ROUNDS to store the values in
+// Returns: Number of values found
+static uint8_t read_runs(char **paths, int count, const char *routine, double *values)
+{
+    uint8_t found = 0;
+
+    for (int i = 0; i < count && found < MAX_ROUNDS; i++)
+    {
+        FILE *f = fopen(paths[i], "r");
+        if (!f)
+        {
+            perror(paths[i]);
+            continue;
+        }
+
+        char line[128];
+        char name[32];
+        double value;
+        while (found < MAX_ROUNDS && fgets(line, sizeof(line), f))
+        {
+            if (sscanf(line, "%31[^,],host,%lf,", name, &value) == 2 && !strcmp(name, routine))
+                values[found++] = value;
+        }
+        fclose(f);
+    }
+    return found;
+}
+
+// Function: add_result
+// Description: Appends a result, ignoring any beyond MAX_RESULTS.
+static void add_result(const char *routine, const char *target, double value, double threshold_pct)
+{
+    if (result_count == MAX_RESULTS)
+        return;
+
+    result *r = &results[result_count++];
+    snprintf(r->routine, sizeof(r->routine), "%s", routine);
+    snprintf(r->target, sizeof(r->target), "%s", target);
+    r->value = value;
+    r->threshold_pct = threshold_pct;
+}
+
+// Function: is_gated
+// Description: Checks whether a result is compared against the baseline.
+static int is_gated(const result *r)
+{
+    return strcmp(r->target, "host_ns") != 0;
+}
+
+// Function: unit
+// Description: Returns the unit of a result's target.
+static const char *unit(const result *r)
+{
+    if (!strcmp(r->target, "avr"))
+        return "cycles/op";
+    return strcmp(r->target, "host") ? "ns/op" : "x_reference";
+}
+
+// Function: read_avr_log
+// Description: Adds the "routine,avr,value,unit" lines found in a capture of the
+//              bench_avr UART output. Other lines are skipped.
+// Parameters:
+//  - path: Path to the captured output
+static int read_avr_log(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    if (!f)
+    {
+        perror(path);
+        return -1;
+    }
+
+    char line[128];
+    char routine[32];
+    double value;
+    while (fgets(line, sizeof(line), f))
+    {
+        if (sscanf(line, "%31[^,],avr,%lf,", routine, &value) == 2)
+            add_result(routine, "avr", value, AVR_THRESHOLD_PCT);
+    }
+    fclose(f);
+    return 0;
+}
+
+// Function: write_results
+// Description: Writes all results as CSV.
+// Parameters:
+//  - path: Output path
+static int write_results(const char *path)
+{
+    FILE *f = fopen(path, "w");
+    if (!f)
+    {
+        perror(path);
+        return -1;
+    }
+
+    fprintf(f, "routine,target,value,unit\n");
+    for (uint8_t i = 0; i < result_count; i++)
+    {
+        fprintf(f, "%s,%s,%.3f,%s\n", results[i].routine, results[i].target, results[i].value, unit(&results[i]));
+    }
+    fclose(f);
+    return 0;
+}
+
+// Function: write_baseline
+// Description: Stores the current gated results as the new baseline.
+// Parameters:
+//  - path: Baseline path
+static int write_baseline(const char *path)
+{
+    FILE *f = fopen(path, "w");
+    if (!f)
+    {
+        perror(path);
+        return -1;
+    }
+
+    fprintf(f, "routine,target,baseline,threshold_pct\n");
+    for (uint8_t i = 0; i < result_count; i++)
+    {
+        if (is_gated(&results[i]))
+        {
+            fprintf(f, "%s,%s,%.3f,%.0f\n", results[i].routine, results[i].target, results[i].value,
+                    results[i].threshold_pct);
+        }
+    }
+    fclose(f);
+    return 0;
+}
+
+// Function: check_baseline
+// Description: Compares every gated result with its baseline entry. A result
+//              without an entry counts as a failure.
+// Parameters:
+//  - path: Baseline path
+// Returns: Number of failures, or -1 if the baseline could not be read
+static int check_baseline(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    if (!f)
+    {
+        perror(path);
+        return -1;
+    }
+
+    result baseline[MAX_RESULTS];
+    uint8_t baseline_count = 0;
+    char line[128];
+    while (baseline_count < MAX_RESULTS && fgets(line, sizeof(line), f))
+    {
+        result *b = &baseline[baseline_count];
+        if (sscanf(line, "%31[^,],%7[^,],%lf,%lf", b->routine, b->target, &b->value, &b->threshold_pct) == 4)
+            baseline_count++; // The header line does not parse and is skipped.
+    }
+    fclose(f);
+
+    int failures = 0;
+    for (uint8_t i = 0; i < result_count; i++)
+    {
+        result *r = &results[i];
+        result *b = NULL;
+
+        if (!is_gated(r))
+            continue;
+
+        for (uint8_t j = 0; j < baseline_count; j++)
+        {
+            if (!strcmp(r->routine, baseline[j].routine) && !strcmp(r->target, baseline[j].target))
+                b = &baseline[j];
+        }
+
+        if (!b)
+        {
+            printf("FAIL  %-24s %-4s %10.3f (no baseline)\n", r->routine, r->target, r->value);
+            failures++;
+            continue;
+        }
+
+        double limit = b->value * (100 + b->threshold_pct) / 100;
+        uint8_t failed = r->value > limit;
+        failures += failed;
+        printf("%s  %-24s %-4s %10.3f (baseline %.3f, limit %.3f)\n", failed ? "FAIL" : "PASS",
+               r->routine, r->target, r->value, b->value, limit);
+    }
+    return failures;
+}
+
+int main(int argc, char **argv)
+{
+    const char *output = "bench_output.csv";
+    const char *baseline = NULL;
+    const char *avr_log = NULL;
+    long rounds = 5;
+    uint8_t update = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "o:b:a:r:w")) != -1)
+    {
+        switch (opt)
+        {
+        case 'o':
+            output = optarg;
+            break;
+        case 'b':
+            baseline = optarg;
+            break;
+        case 'a':
+            avr_log = optarg;
+            break;
+        case 'r':
+            rounds = strtol(optarg, NULL, 10);
+            break;
+        case 'w':
+            update = 1;
+            break;
+        default:
+            fprintf(stderr, "Usage: %s [-o results.csv] [-b baseline.csv] [-a avr_log] [-r rounds] [-w]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (rounds < 1 || rounds > MAX_ROUNDS)
+    {
+        fprintf(stderr, "rounds must be 1 to %d\n", MAX_ROUNDS);
+        return 1;
+    }
+
+    // Warm up caches, branch predictors and the CPU clock before anything is recorded.
+    for (uint8_t i = 0; i < bench_routine_count; i++)
+    {
+        time_calls(bench_reference);
+        time_calls(bench_routines[i].run);
+    }
+
+    static double ns[MAX_RESULTS][MAX_ROUNDS];
+    static double ratios[MAX_RESULTS][MAX_ROUNDS];
+
+    for (uint8_t round = 0; round < rounds; round++)
+    {
+        for (uint8_t i = 0; i < bench_routine_count; i++)
+        {
+            measure(bench_routines[i].run, &ns[i][round], &ratios[i][round]);
+        }
+    }
+
+    for (uint8_t i = 0; i < bench_routine_count; i++)
+    {
+        double ratio = median(ratios[i], rounds);
+        double threshold_pct = threshold_from_spread(ratios[i], rounds);
+
+        if (update && optind < argc)
+        {
+            // Aggregate the earlier runs instead of this one.
+            double runs[MAX_ROUNDS];
+            uint8_t found = read_runs(&argv[optind], argc - optind, bench_routines[i].name, runs);
+            if (!found)
+            {
+                fprintf(stderr, "%s: no runs recorded\n", bench_routines[i].name);
+                return 1;
+            }
+            ratio = median(runs, found);
+            threshold_pct = threshold_from_spread(runs, found);
+        }
+
+        add_result(bench_routines[i].name, "host_ns", median(ns[i], rounds), 0);
+        add_result(bench_routines[i].name, "host", ratio, threshold_pct);
+    }
+
+    if (avr_log && read_avr_log(avr_log) < 0)
+        return 1;
+
+    if (write_results(output) < 0)
+        return 1;
+
+    if (!baseline)
+        return 0;
+
+    if (update)
+        return write_baseline(baseline) < 0;
+
+    int failures = check_baseline(baseline);
+    if (failures > 0)
+        fprintf(stderr, "%d routine(s) failed\n", failures);
+    return failures != 0;
+}
@@ -0,0 +1,9 @@
+#include <avr/io.h>
+
+// Register blocks read and written by the firmware sources on the host.
+PORT_t PORTA = {.IN = 0xFF};
+TCA_t TCA0;
+ADC_t ADC0;
+SPI_t SPI0;
+TCB_t TCB0;
+TCB_t TCB1;
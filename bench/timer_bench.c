@@ -0,0 +1,22 @@
+// Builds timer.c into the benchmarks. pb_debounce() stays static in the
+// firmware, so it is reached from this translation unit instead.
+#include "../src/timer.c"
+
+#include "bench.h"
+
+void bench_pb_debounce(uint8_t i)
+{
+    for (uint8_t j = 0; j < BENCH_INNER; j++)
+    {
+#ifndef __AVR__
+        // Hold all buttons down for 8 samples then release them for 8, so the
+        // vertical counter counts and the debounced state flips. On the AVR the
+        // routine is branchless, so reading the idle pins costs the same.
+        PORTA.IN = ((uint8_t)(i + j) & 0x08) ? 0xFF : 0x0F;
+#else
+        (void)i;
+#endif
+        pb_debounce();
+        bench_sink = pb_debounced_state;
+    }
+}
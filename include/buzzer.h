@@ -4,6 +4,8 @@
 #define MIN_OCTAVE -3
 
 void buzzer_on(const uint8_t tone);
+uint16_t buzzer_period(const uint8_t tone);
+void buzzer_set_period(const uint16_t period);
 void buzzer_off(void);
 void decrease_octave(void);
 void increase_octave(void);
\ No newline at end of file
@@ -4,4 +4,5 @@ extern volatile uint8_t left_byte;
 extern volatile uint8_t right_byte;
 
 void update_display(const uint8_t left, const uint8_t right);
-void display_segment(uint8_t step);
\ No newline at end of file
+void display_segment(uint8_t step);
+void extract_digits(uint32_t number, uint8_t *left_digit, uint8_t *right_digit);
\ No newline at end of file
@@ -0,0 +1,18 @@
+#include <stdint.h>
+
+#define INPUT_QUEUE_SIZE 8 // Must be a power of two.
+
+typedef enum
+{
+    SOURCE_PB,
+    SOURCE_UART
+} input_sources;
+
+extern volatile uint8_t key_pressed;
+extern uint8_t pb_falling;
+extern uint8_t pb_rising;
+
+void check_edge(void);
+void input_update(uint8_t accept);
+uint8_t input_next(uint8_t *button_index, input_sources *source);
+uint8_t input_released(uint8_t button_index, input_sources source);
@@ -0,0 +1,23 @@
+#include <stdint.h>
+
+// Linear Shift Feedback Register (LSFR) tap mask.
+#define LSFR_MASK 0xE2023CAB
+
+// Function: Linear Shift Feedback Register
+// Description: Produces a deterministic pseudo-random number. Defined in the
+//              header so it is inlined into the main loop.
+// Parameters:
+//  - state: Pointer to the current state of the LSFR
+//  - step: Pointer to the variable to store the next step
+//  - result: Pointer to store the least significant bit of the state
+static inline void LSFR(uint32_t *state, uint8_t *step, uint8_t *result)
+{
+    *result = *state & 1;
+    *state >>= 1;
+
+    if (*result)
+    {
+        *state ^= LSFR_MASK;
+    }
+    *step = (uint8_t)(*state & 0b11);
+}
@@ -3,7 +3,8 @@
 volatile uint16_t playback_delay_ms;
 extern volatile uint8_t pb_debounced_state;
 volatile uint16_t elapsed_time;
+uint16_t playback_delay_from_adc(uint8_t adc_result);
 void prepare_delay(void);
 void playback_delay(void);
 void half_playback_delay(void);
-uint8_t delay_ready;
\ No newline at end of file
+extern uint16_t staged_delay_ms;
\ No newline at end of file
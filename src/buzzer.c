@@ -5,21 +5,37 @@
 
 volatile int8_t octave = 0;
 
-// Function: buzzer_on
-// Description: Turns the buzzer on to a given frequency with a 50% duty cycle.
+// Function: buzzer_period
+// Description: Calculates the timer period of a tone at the current octave.
 // Parameters:
-//  - tone: Index of the tone to be played (0 to 3)
-void buzzer_on(uint8_t tone)
+//  - tone: Index of the tone (0 to 3)
+uint16_t buzzer_period(uint8_t tone)
 {
     // Predefined periods, scaled down by 3 left bit shifts, to prevent negative bitshifts.
     static const uint32_t periods[4] = {41280, 49020, 30936, 82816};
 
-    uint16_t period = periods[tone] >> (octave + 3); // Adjust for scaling.
+    return periods[tone] >> (octave + 3); // Adjust for scaling.
+}
 
+// Function: buzzer_set_period
+// Description: Turns the buzzer on with a precalculated period and a 50% duty cycle.
+// Parameters:
+//  - period: Timer period, as returned by buzzer_period
+void buzzer_set_period(uint16_t period)
+{
     TCA0.SINGLE.PERBUF = period;
     TCA0.SINGLE.CMP0BUF = period >> 1; // 50% duty cycle
 }
 
+// Function: buzzer_on
+// Description: Turns the buzzer on to a given frequency with a 50% duty cycle.
+// Parameters:
+//  - tone: Index of the tone to be played (0 to 3)
+void buzzer_on(uint8_t tone)
+{
+    buzzer_set_period(buzzer_period(tone));
+}
+
 // Function: increase_octave
 // Description: Increases the octave by one step, ensuring the octave doesn't exceed the limit (3).
 void increase_octave(void)
@@ -45,6 +45,34 @@ void display_segment(uint8_t step)
     }
 }
 
+// Function: extract_digits
+// Description: Separates an integer into its tens and units digits
+// Parameters:
+//  - number: The number to be split into digits
+//  - left_digit: Pointer to store the tens digit
+//  - right_digit: Pointer to store the units digit
+void extract_digits(uint32_t number, uint8_t *left_digit, uint8_t *right_digit)
+{
+    uint8_t tens_count = 0;
+
+    while (number > 10)
+    {
+        number -= 10;
+        tens_count++;
+    }
+
+    if (tens_count < 1)
+    {
+        *left_digit = 10; // Setting as ten will leave the display blank.
+    }
+    else
+    {
+        *left_digit = tens_count;
+    }
+
+    *right_digit = number;
+}
+
 // Interrupt Service Routine: SPI0_INT_vect
 // Description: Handles SPI interrupt, latching the display values
 ISR(SPI0_INT_vect)
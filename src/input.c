@@ -0,0 +1,122 @@
+#include "input.h"
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <stdint.h>
+
+#include "timer.h"
+
+#define BUTTONS_MASK (PIN4_bm | PIN5_bm | PIN6_bm | PIN7_bm)
+
+// Variables for pushbutton edge detection:
+uint8_t pb_sample = 0xFF;
+uint8_t pb_sample_r = 0xFF;
+uint8_t pb_changed;
+uint8_t pb_falling;
+uint8_t pb_rising;
+
+// Bitmask of keys received over UART, set by USART0_RXC_vect.
+volatile uint8_t key_pressed = 0;
+
+// Struct containing the press/hold/release state of one input source.
+typedef struct input_source
+{
+    uint8_t held;    // Buttons currently held down
+    uint8_t pressed; // Buttons pressed since the last update
+} input_source;
+
+input_source sources[2];
+
+// Pending presses, each encoded as (source << 2) | button index.
+uint8_t input_queue[INPUT_QUEUE_SIZE];
+uint8_t queue_head = 0;
+uint8_t queue_count = 0;
+
+// Function: check_edge
+// Description: Checks for rising or falling edges from the pushbuttons.
+void check_edge(void)
+{
+    pb_sample_r = pb_sample;
+    pb_sample = pb_debounced_state;
+
+    pb_changed = pb_sample_r ^ pb_sample;
+
+    pb_falling = pb_changed & pb_sample_r;
+    pb_rising = pb_changed & pb_sample;
+}
+
+// Function: input_update
+// Description: Samples both input sources and queues every new press. Presses
+//              from the same pass are queued in button order, pushbutton before
+//              UART, so overlapping input resolves the same way every time.
+//              A press on both sources in the same pass is queued twice.
+// Parameters:
+//  - accept: Non-zero to queue presses, zero to discard them and flush the queue
+void input_update(uint8_t accept)
+{
+    check_edge();
+
+    // Take the UART keys atomically so a key arriving now is not lost.
+    cli();
+    uint8_t keys = key_pressed;
+    key_pressed = 0;
+    sei();
+
+    sources[SOURCE_PB].pressed = pb_falling & BUTTONS_MASK;
+    sources[SOURCE_PB].held = ~pb_sample & BUTTONS_MASK;
+
+    // UART keys have no hold, they are pressed and released at once.
+    sources[SOURCE_UART].pressed = keys & BUTTONS_MASK;
+    sources[SOURCE_UART].held = 0;
+
+    if (!accept)
+    {
+        queue_count = 0;
+        return;
+    }
+
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        uint8_t pin = PIN4_bm << i;
+
+        for (uint8_t source = SOURCE_PB; source <= SOURCE_UART; source++)
+        {
+            // Only drops input if more than INPUT_QUEUE_SIZE presses are pending.
+            if ((sources[source].pressed & pin) && queue_count < INPUT_QUEUE_SIZE)
+            {
+                input_queue[(queue_head + queue_count) & (INPUT_QUEUE_SIZE - 1)] = (source << 2) | i;
+                queue_count++;
+            }
+        }
+    }
+}
+
+// Function: input_next
+// Description: Takes the oldest queued press.
+// Parameters:
+//  - button_index: Pointer to store the index of the button pressed (0 to 3)
+//  - source: Pointer to store the source of the press
+// Returns: 1 if a press was taken, 0 if the queue is empty
+uint8_t input_next(uint8_t *button_index, input_sources *source)
+{
+    if (!queue_count)
+        return 0;
+
+    uint8_t entry = input_queue[queue_head];
+    queue_head = (queue_head + 1) & (INPUT_QUEUE_SIZE - 1);
+    queue_count--;
+
+    *button_index = entry & 0b11;
+    *source = entry >> 2;
+    return 1;
+}
+
+// Function: input_released
+// Description: Checks whether a button is no longer held on the given source.
+// Parameters:
+//  - button_index: Index of the button (0 to 3)
+//  - source: Source the button was pressed on
+uint8_t input_released(uint8_t button_index, input_sources source)
+{
+    return !(sources[source].held & (PIN4_bm << button_index));
+}
@@ -4,19 +4,15 @@
 #include <util/delay.h>
 #include "display_macros.h"
 #include "initialisation.h"
+#include "input.h"
+#include "sequence.h"
 #include "timer.h"
 #include "types.h"
 #include "uart.h"
 
 // Variables for pushbutton/key press handling:
-uint8_t pb_sample = 0xFF;
-uint8_t pb_sample_r = 0xFF;
-uint8_t pb_changed;
-uint8_t pb_falling;
-uint8_t pb_rising;
-volatile uint8_t key_pressed = 0;
-uint8_t pb_released = 0;
-uint8_t pushbutton_received = 0;
+uint8_t input_was_released = 0; // Set once the active input (pushbutton or UART) is released.
+input_sources active_source;
 
 // Variables for gameplay state:
 uint8_t user_input = 0;
@@ -24,12 +20,18 @@ uint8_t input_count = 0;
 uint8_t user_correct = 1;
 
 // Linear Shift Feedback Register (LSFR) variables:
-uint32_t mask = 0xE2023CAB;
 uint32_t re_init_state = 0x11592931;
 uint32_t state_lsfr;
 uint8_t step;
 uint8_t result;
 
+// Round staging buffer, filled while SUCCESS/FAIL feedback is displayed.
+#define STAGE_STEPS 32
+uint8_t staged_steps[STAGE_STEPS >> 2]; // 2-bit steps, packed four per byte.
+uint16_t staged_periods[4];             // Tone periods at the staged octave.
+uint8_t staged_count = 0;               // Number of staged steps, 0 if nothing is staged.
+uint32_t staged_state;                  // LSFR state after the last staged step.
+
 // Display variables:
 uint8_t right_digit;
 uint8_t left_digit;
@@ -38,35 +40,38 @@ uint8_t left_digit;
 buttons button = WAIT;
 gameplay_stages gameplay_stage = INIT;
 
-// Function: Linear Shift Feedback Register
-// Description: Produces a deterministic pseudo-random number.
+// Function: stage_round
+// Description: Precomputes the next round's steps, tone periods and playback
+//              delay, so SIMON can begin playback at once.
 // Parameters:
-//  - state: Pointer to the current state of the LSFR
-//  - step: Pointer to the variable to store the next step
-//  - result: Pointer to store the least significant bit of the statevoid
-void LSFR(uint32_t *state, uint8_t *step, uint8_t *result)
+//  - length: Sequence length of the next round
+void stage_round(uint16_t length)
 {
-    *result = *state & 1;
-    *state >>= 1;
+    uint32_t stage_state = re_init_state;
+    uint8_t stage_step;
+    uint8_t stage_result;
+
+    staged_count = (length < STAGE_STEPS) ? length : STAGE_STEPS;
 
-    if (*result)
+    for (uint8_t i = 0; i < (STAGE_STEPS >> 2); i++)
     {
-        *state ^= mask;
+        staged_steps[i] = 0;
     }
-    *step = (uint8_t)(*state & 0b11);
-}
 
-// Function: check_edge
-// Description: Checks for rising or falling edges from the pushbuttons.
-void check_edge(void)
-{
-    pb_sample_r = pb_sample;
-    pb_sample = pb_debounced_state;
+    for (uint8_t i = 0; i < staged_count; i++)
+    {
+        LSFR(&stage_state, &stage_step, &stage_result);
+        staged_steps[i >> 2] |= stage_step << ((i & 0b11) << 1);
+    }
+    staged_state = stage_state; // Steps beyond the buffer continue from here.
 
-    pb_changed = pb_sample_r ^ pb_sample;
+    // The octave can only change during PLAYER, so these stay valid until playback.
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        staged_periods[i] = buzzer_period(i);
+    }
 
-    pb_falling = pb_changed & pb_sample_r;
-    pb_rising = pb_changed & pb_sample;
+    prepare_delay(); // Sample and calculate the next playback delay.
 }
 
 // Struct containing enum type buttons and their associated bitmasks.
@@ -79,34 +84,6 @@ typedef struct buttons_pins
 // Array of mapped bitmasks and buttons.
 button_pin arr[4] = {{PIN4_bm, BUTTON1}, {PIN5_bm, BUTTON2}, {PIN6_bm, BUTTON3}, {PIN7_bm, BUTTON4}};
 
-// Function: extract_digits
-// Description: Separates an integer into its tens and units digits
-// Parameters:
-//  - number: The number to be split into digits
-//  - left_digit: Pointer to store the tens digit
-//  - right_digit: Pointer to store the units digit
-void extract_digits(uint32_t number, uint8_t *left_digit, uint8_t *right_digit)
-{
-    uint8_t tens_count;
-
-    while (number > 10)
-    {
-        number -= 10;
-        tens_count++;
-    }
-
-    if (tens_count < 1)
-    {
-        *left_digit = 10; // Setting as ten will leave the display blank.
-    }
-    else
-    {
-        *left_digit = tens_count;
-    }
-
-    *right_digit = number;
-}
-
 // Indexed digits encoded within hexadecimal values.
 volatile uint8_t segs[] = {0x08, 0x6B, 0x44, 0x41, 0x23, 0x11, 0x10, 0x4B, 0x00, 0x01, 0xFF};
 
@@ -125,16 +102,11 @@ void handle_button(uint8_t button_index)
         user_correct = 0;
     }
 
-    if (!pb_released)
+    if (!input_was_released)
     {
-        if (pb_rising & arr[button_index].pin) // If the pushbutton was released.
+        if (input_released(button_index, active_source)) // UART input is released immediately.
         {
-            pb_released = 1;
-            pushbutton_received = 0; // Reset flag.
-        }
-        else if (!pushbutton_received) // If there was not a pushbutton input (UART input).
-        {
-            pb_released = 1;
+            input_was_released = 1;
         }
     }
     else
@@ -145,7 +117,7 @@ void handle_button(uint8_t button_index)
             buzzer_off();
             display_segment(4);
             user_input = 1;  // Set user input flage.
-            pb_released = 0; // Reset pushbutton released flag.
+            input_was_released = 0; // Reset input released flag.
             button = WAIT;
         }
     }
@@ -166,55 +138,60 @@ int main(void)
 
     while (1)
     {
-        check_edge();
+        input_update(gameplay_stage == PLAYER); // Only queue input during the user's turn.
 
         switch (gameplay_stage)
         {
         case INIT:
             sequence_length = 1; // Unitialise the sequence length to 1 on reset/initialisation.
+            if (!staged_count)   // FAIL stages the next round itself.
+            {
+                stage_round(sequence_length);
+            }
             gameplay_stage = SIMON;
             break;
         case SIMON:
-            state_lsfr = re_init_state; // Initialise state to recreate the same sequence of steps as re_init_state.
-            prepare_delay();
-            if (delay_ready)
+            playback_delay_ms = staged_delay_ms; // Delay was sampled while feedback was shown.
+
+            // Continue from the staged steps for longer sequences, or generate every step if nothing was staged.
+            state_lsfr = staged_count ? staged_state : re_init_state;
+            for (int i = 0; i < sequence_length; i++)
             {
-                for (int i = 0; i < sequence_length; i++)
+                if (i < staged_count)
+                {
+                    step = (staged_steps[i >> 2] >> ((i & 0b11) << 1)) & 0b11; // Use staged step.
+                    buzzer_set_period(staged_periods[step]);
+                }
+                else
                 {
                     LSFR(&state_lsfr, &step, &result); // Create new step
                     buzzer_on(step);
-                    display_segment(step);
-                    half_playback_delay(); // Half delay
-                    buzzer_off();
-                    display_segment(4);    // Display off.
-                    half_playback_delay(); // Half delay
                 }
-                state_lsfr = re_init_state; // Re-initialise state to recreate the same sequence, for the user's, as displayed by Simon.
-                gameplay_stage = PLAYER;
+                display_segment(step);
+                half_playback_delay(); // Half delay
+                buzzer_off();
+                display_segment(4);    // Display off.
+                half_playback_delay(); // Half delay
             }
+            state_lsfr = re_init_state; // Re-initialise state to recreate the same sequence, for the user's, as displayed by Simon.
+            staged_count = 0;           // Staged round consumed.
+            gameplay_stage = PLAYER;
             break;
         case PLAYER:
             switch (button)
             {
             case WAIT:
-                for (int i = 0; i < 4; i++) // Loop through each button/key.
+            {
+                uint8_t button_index;
+                if (input_next(&button_index, &active_source)) // Take the oldest queued press, if any.
                 {
-                    if ((pb_falling | key_pressed) & arr[i].pin) // Check if pushbutton or key pressed.
-                    {
-                        LSFR(&state_lsfr, &step, &result); // Update the step to compare the user's input to.
-                        key_pressed = 0;                   // Rest key pressed flag bitmask.
-                        elapsed_time = 0;                  // Start timer.
-                        input_count++;                     // Log input.
-                        button = arr[i].button;            // Change states.
-                    }
-
-                    // Check if the input came from the pushbutton.
-                    if (pb_falling & arr[i].pin)
-                    {
-                        pushbutton_received = 1;
-                    }
+                    LSFR(&state_lsfr, &step, &result); // Update the step to compare the user's input to.
+                    elapsed_time = 0;                  // Start timer.
+                    input_count++;                     // Log input.
+                    button = arr[button_index].button; // Change states.
                 }
                 break;
+            }
             case BUTTON1:
                 handle_button(0);
                 break;
@@ -253,21 +230,23 @@ int main(void)
             break;
         case SUCCESS:
             update_display(0, 0); // Success pattern.
+            sequence_length++;
+            stage_round(sequence_length); // Prepare the next round while the pattern is shown.
             playback_delay();
             display_segment(4); // Display off.
-            sequence_length++;
             gameplay_stage = SIMON;
             break;
         case FAIL:
             update_display(0b01110111, 0b01110111); // Fail pattern.
+            LSFR(&state_lsfr, &step, &result); // Get next step to re-initialise to.
+            re_init_state = state_lsfr;        // Re-initialise sequence to where it was left off.
+            stage_round(1);                    // Prepare the restarted round while feedback is shown.
             playback_delay();
             extract_digits(sequence_length, &left_digit, &right_digit); // Extract digits from the sequence length (user's score) to be displayed.
             update_display(segs[left_digit], segs[right_digit]);
             playback_delay();
             display_segment(4); // Display off.
             playback_delay();
-            LSFR(&state_lsfr, &step, &result); // Get next step to re-initialise to.
-            re_init_state = state_lsfr;        // Re-initialise sequence to where it was left off.
             gameplay_stage = INIT;
             break;
         default:
@@ -8,6 +8,7 @@
 #include "display_macros.h"
 
 volatile uint8_t pb_debounced_state = 0xFF;
+uint16_t staged_delay_ms = 250; // Next round's playback delay, applied when SIMON starts.
 
 // Function: pb_debounce
 // Description: Debounces the push buttons using a vertical counter method.
@@ -47,25 +48,36 @@ static void spi_write(void)
     current_side = !current_side;
 }
 
+// Function: playback_delay_from_adc
+// Description: Maps a potentiometer reading to a playback delay (250ms to 2s).
+// Parameters:
+//  - adc_result: 8-bit ADC result
+uint16_t playback_delay_from_adc(uint8_t adc_result)
+{
+    return (6.8 * adc_result) + 250;
+}
+
 // Function: prepare_delay
-// Description: Prepares the playback delay based on ADC result.
+// Description: Samples the potentiometer and calculates the next playback delay
+//              into staged_delay_ms. Waits for the conversion (tens of
+//              microseconds), so it is called while feedback is displayed.
 void prepare_delay(void)
 {
-    // Start ADC conversion
+    // Discard any stale result and start ADC conversion
+    ADC0.INTFLAGS = ADC_RESRDY_bm;
     ADC0.COMMAND |= ADC_START_IMMEDIATE_gc;
 
-    delay_ready = ADC0.INTFLAGS & ADC_RESRDY_bm; // Check if ADC conversion is complete
-
-    if (delay_ready)
+    while (!(ADC0.INTFLAGS & ADC_RESRDY_bm))
     {
-        // Read the result
-        uint8_t adc_result = ADC0.RESULT;
+    } // Wait for the conversion to complete.
 
-        // Clear the Result Ready flag
-        ADC0.INTFLAGS = ADC_RESRDY_bm;
+    // Read the result
+    uint8_t adc_result = ADC0.RESULT;
 
-        playback_delay_ms = (6.8 * adc_result) + 250; // Calculate playback delay
-    }
+    // Clear the Result Ready flag
+    ADC0.INTFLAGS = ADC_RESRDY_bm;
+
+    staged_delay_ms = playback_delay_from_adc(adc_result); // Calculate playback delay
 }
 
 // Function: playback_delay
@@ -4,10 +4,10 @@
 #include "uart.h"
 #include "buzzer.h"
 #include "display.h"
+#include "input.h"
 
 buttons button;
 gameplay_stages gameplay_stage;
-volatile uint8_t key_pressed;
 
 // Interrupt Service Routine: USART0_RXC_vect
 // Description: Handles USART0 receive complete interrupt
@@ -24,19 +24,19 @@ ISR(USART0_RXC_vect)
         {
         case '1':
         case 'q':
-            key_pressed = PIN4_bm;
+            key_pressed |= PIN4_bm; // Accumulate until main takes them.
             break;
         case '2':
         case 'w':
-            key_pressed = PIN5_bm;
+            key_pressed |= PIN5_bm;
             break;
         case '3':
         case 'e':
-            key_pressed = PIN6_bm;
+            key_pressed |= PIN6_bm;
             break;
         case '4':
         case 'r':
-            key_pressed = PIN7_bm;
+            key_pressed |= PIN7_bm;
             break;
         case ',':
         case 'k':
@@ -47,7 +47,6 @@ ISR(USART0_RXC_vect)
             decrease_octave();
             break;
         default:
-            key_pressed = 0;
             break;
         }
     }
@@ -0,0 +1,484 @@
+// Host bridge for multiple Simon Says sessions.
+//
+// Multiplexes any number of QUTy serial ports and locally created ptys (for
+// simulated instances) over a single epoll loop. Scripted bot input is sent
+// using the same single key protocol that USART0_RXC_vect reads, any UART output
+// is collected per session, and per-session latency/throughput statistics are
+// printed on SIGUSR1 and on exit.
+//
+// Latency is measured from a key to the next byte the session sends back. The
+// game firmware does not transmit anything yet (nothing calls uart_puts()), so
+// against a real board replies stay 0 and only the tx counters are meaningful.
+//
+// Usage: bridge [-s script] [-i interval_ms] [-l] [-n ptys] [-o log_dir] [device...]
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_EVENTS 64
+#define READ_CHUNK 256
+
+// epoll data values that tell the timer and signal fds apart from session indices.
+#define TAG_TIMER 0xFFFFFFFEu
+#define TAG_SIGNAL 0xFFFFFFFFu
+
+typedef struct session
+{
+    int fd;            // Serial port or pty master
+    int hold_fd;       // pty slave kept open so the master never reads EIO
+    char name[64];     // Device path or pty slave path
+    FILE *log;         // Collected board output, NULL if not logging
+    size_t script_pos; // Next key of the bot script to send
+    uint64_t sent_ns;  // Time the oldest unanswered key was sent, 0 if none
+    uint8_t closed;    // Set once the board hangs up, the session is then skipped
+    uint64_t bytes_tx;
+    uint64_t bytes_rx;
+    uint64_t replies;
+    uint64_t latency_total_ns;
+    uint64_t latency_min_ns;
+    uint64_t latency_max_ns;
+} session;
+
+static session *sessions;
+static size_t session_count;
+static char *script;
+static size_t script_len;
+static uint8_t loop_script = 0;
+static uint64_t start_ns;
+
+// Function: now_ns
+// Description: Returns the monotonic clock in nanoseconds.
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+// Function: is_protocol_key
+// Description: Checks a character against the keys handled by USART0_RXC_vect.
+// Parameters:
+//  - c: Character to check
+static int is_protocol_key(char c)
+{
+    return c != '\0' && strchr("1234qwer,.kl", c) != NULL;
+}
+
+// Function: load_script
+// Description: Reads a bot script, ignoring whitespace and rejecting any key
+//              the firmware would not understand.
+// Parameters:
+//  - path: Path to the script file
+static int load_script(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    if (!f)
+    {
+        perror(path);
+        return -1;
+    }
+
+    size_t capacity = 256;
+    script = malloc(capacity);
+    int c;
+    while (script && (c = fgetc(f)) != EOF)
+    {
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\r')
+            continue;
+
+        if (!is_protocol_key((char)c))
+        {
+            fprintf(stderr, "%s: invalid key '%c'\n", path, c);
+            fclose(f);
+            return -1;
+        }
+
+        if (script_len == capacity)
+        {
+            capacity <<= 1;
+            script = realloc(script, capacity);
+            if (!script)
+                break;
+        }
+        script[script_len++] = (char)c;
+    }
+    fclose(f);
+
+    if (!script)
+    {
+        perror("script");
+        return -1;
+    }
+    return 0;
+}
+
+// Function: make_raw
+// Description: Configures a terminal for raw 8N1 at 9600 baud to match uart_init().
+// Parameters:
+//  - fd: Terminal file descriptor
+//  - vmin: Minimum bytes for a blocking read, 1 for a pty slave handed to a
+//          simulated instance so its reads block instead of returning 0
+static int make_raw(int fd, uint8_t vmin)
+{
+    struct termios tio;
+    if (tcgetattr(fd, &tio) < 0)
+        return -1;
+
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, B9600);
+    cfsetospeed(&tio, B9600);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cc[VMIN] = vmin;
+    tio.c_cc[VTIME] = 0;
+
+    return tcsetattr(fd, TCSANOW, &tio);
+}
+
+// Function: add_session
+// Description: Appends a session and registers it with epoll.
+// Parameters:
+//  - epfd: epoll instance
+//  - fd: Session file descriptor (already non-blocking)
+//  - hold_fd: pty slave to keep open, or -1
+//  - name: Display name of the session
+//  - log_dir: Directory for output logs, or NULL
+static int add_session(int epfd, int fd, int hold_fd, const char *name, const char *log_dir)
+{
+    session *grown = realloc(sessions, (session_count + 1) * sizeof(session));
+    if (!grown)
+        return -1;
+    sessions = grown;
+
+    session *s = &sessions[session_count];
+    memset(s, 0, sizeof(*s));
+    s->fd = fd;
+    s->hold_fd = hold_fd;
+    s->latency_min_ns = UINT64_MAX;
+    snprintf(s->name, sizeof(s->name), "%s", name);
+
+    if (log_dir)
+    {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/session%zu.log", log_dir, session_count);
+        s->log = fopen(path, "w");
+        if (!s->log)
+        {
+            perror(path);
+            return -1;
+        }
+    }
+
+    struct epoll_event ev = {.events = EPOLLIN, .data.u32 = (uint32_t)session_count};
+    if (epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev) < 0)
+        return -1;
+
+    session_count++;
+    return 0;
+}
+
+// Function: open_device
+// Description: Opens a board's serial port as a session.
+// Parameters:
+//  - epfd: epoll instance
+//  - path: Serial device path
+//  - log_dir: Directory for output logs, or NULL
+static int open_device(int epfd, const char *path, const char *log_dir)
+{
+    int fd = open(path, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0 || make_raw(fd, 0) < 0)
+    {
+        perror(path);
+        return -1;
+    }
+    return add_session(epfd, fd, -1, path, log_dir);
+}
+
+// Function: open_pty
+// Description: Creates a local pty session for a simulated instance to attach to.
+// Parameters:
+//  - epfd: epoll instance
+//  - log_dir: Directory for output logs, or NULL
+static int open_pty(int epfd, const char *log_dir)
+{
+    int master = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (master < 0 || grantpt(master) < 0 || unlockpt(master) < 0)
+    {
+        perror("posix_openpt");
+        return -1;
+    }
+
+    const char *slave_name = ptsname(master);
+    int slave = slave_name ? open(slave_name, O_RDWR | O_NOCTTY | O_CLOEXEC) : -1;
+    if (slave < 0 || make_raw(slave, 1) < 0)
+    {
+        perror("pty slave");
+        return -1;
+    }
+
+    printf("%s\n", slave_name); // Simulated instances attach to the slave side.
+    return add_session(epfd, master, slave, slave_name, log_dir);
+}
+
+// Function: send_next_key
+// Description: Writes the session's next scripted key, if any.
+// Parameters:
+//  - s: Session to advance
+static void send_next_key(session *s)
+{
+    if (s->closed)
+        return;
+
+    if (s->script_pos >= script_len)
+    {
+        if (!loop_script || script_len == 0)
+            return;
+        s->script_pos = 0;
+    }
+
+    if (write(s->fd, &script[s->script_pos], 1) == 1)
+    {
+        s->script_pos++;
+        s->bytes_tx++;
+        if (!s->sent_ns)
+            s->sent_ns = now_ns(); // Latency is measured from the oldest unanswered key.
+    }
+}
+
+// Function: read_session
+// Description: Drains pending board output and records reply latency. A hung-up
+//              or failed fd is removed from epoll and the session marked closed,
+//              since a level-triggered hangup would otherwise fire forever.
+// Parameters:
+//  - epfd: epoll instance
+//  - s: Session with readable data, or a hangup/error
+static void read_session(int epfd, session *s)
+{
+    char buffer[READ_CHUNK];
+    ssize_t n;
+
+    while ((n = read(s->fd, buffer, sizeof(buffer))) > 0)
+    {
+        if (s->sent_ns)
+        {
+            uint64_t latency = now_ns() - s->sent_ns;
+            s->latency_total_ns += latency;
+            if (latency < s->latency_min_ns)
+                s->latency_min_ns = latency;
+            if (latency > s->latency_max_ns)
+                s->latency_max_ns = latency;
+            s->replies++;
+            s->sent_ns = 0;
+        }
+
+        s->bytes_rx += (uint64_t)n;
+        if (s->log)
+            fwrite(buffer, 1, (size_t)n, s->log);
+    }
+
+    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EINTR))
+    {
+        // Board unplugged: stop polling it but keep its statistics.
+        epoll_ctl(epfd, EPOLL_CTL_DEL, s->fd, NULL);
+        s->closed = 1;
+        s->sent_ns = 0;
+        fprintf(stderr, "%s: disconnected\n", s->name);
+    }
+}
+
+// Function: print_stats
+// Description: Prints latency and throughput for every session to stderr.
+static void print_stats(void)
+{
+    double elapsed = (double)(now_ns() - start_ns) / 1e9;
+    if (elapsed <= 0)
+        elapsed = 1;
+
+    fprintf(stderr, "%-24s %8s %8s %8s %10s %10s %10s %9s %9s\n",
+            "session", "tx", "rx", "replies", "avg_us", "min_us", "max_us", "tx_B/s", "rx_B/s");
+
+    for (size_t i = 0; i < session_count; i++)
+    {
+        session *s = &sessions[i];
+        double avg = s->replies ? (double)s->latency_total_ns / s->replies / 1e3 : 0;
+        double min = s->replies ? (double)s->latency_min_ns / 1e3 : 0;
+        double max = (double)s->latency_max_ns / 1e3;
+
+        fprintf(stderr, "%-24s %8llu %8llu %8llu %10.1f %10.1f %10.1f %9.1f %9.1f\n",
+                s->name, (unsigned long long)s->bytes_tx, (unsigned long long)s->bytes_rx,
+                (unsigned long long)s->replies, avg, min, max,
+                s->bytes_tx / elapsed, s->bytes_rx / elapsed);
+    }
+}
+
+// Function: raise_fd_limit
+// Description: Raises the open file limit so hundreds of sessions fit.
+static void raise_fd_limit(void)
+{
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0)
+    {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+static void usage(const char *program)
+{
+    fprintf(stderr, "Usage: %s [-s script] [-i interval_ms] [-l] [-n ptys] [-o log_dir] [device...]\n", program);
+}
+
+int main(int argc, char **argv)
+{
+    const char *log_dir = NULL;
+    long interval_ms = 500;
+    long pty_count = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "s:i:ln:o:")) != -1)
+    {
+        switch (opt)
+        {
+        case 's':
+            if (load_script(optarg) < 0)
+                return 1;
+            break;
+        case 'i':
+            interval_ms = strtol(optarg, NULL, 10);
+            break;
+        case 'l':
+            loop_script = 1;
+            break;
+        case 'n':
+            pty_count = strtol(optarg, NULL, 10);
+            break;
+        case 'o':
+            log_dir = optarg;
+            break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (interval_ms <= 0 || pty_count < 0 || (pty_count == 0 && optind == argc))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    raise_fd_limit();
+
+    int epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (epfd < 0)
+    {
+        perror("epoll_create1");
+        return 1;
+    }
+
+    for (int i = optind; i < argc; i++)
+    {
+        if (open_device(epfd, argv[i], log_dir) < 0)
+            return 1;
+    }
+    for (long i = 0; i < pty_count; i++)
+    {
+        if (open_pty(epfd, log_dir) < 0)
+            return 1;
+    }
+    fflush(stdout);
+
+    // A single timer paces the bot for every session.
+    int timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    struct itimerspec tick = {
+        .it_interval = {interval_ms / 1000, (interval_ms % 1000) * 1000000},
+        .it_value = {interval_ms / 1000, (interval_ms % 1000) * 1000000},
+    };
+    timerfd_settime(timer_fd, 0, &tick, NULL);
+
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    sigaddset(&signals, SIGUSR1);
+    sigprocmask(SIG_BLOCK, &signals, NULL);
+    int signal_fd = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+
+    struct epoll_event ev = {.events = EPOLLIN, .data.u32 = TAG_TIMER};
+    epoll_ctl(epfd, EPOLL_CTL_ADD, timer_fd, &ev);
+    ev.data.u32 = TAG_SIGNAL;
+    epoll_ctl(epfd, EPOLL_CTL_ADD, signal_fd, &ev);
+
+    start_ns = now_ns();
+    uint8_t running = 1;
+    struct epoll_event events[MAX_EVENTS];
+
+    while (running)
+    {
+        int ready = epoll_wait(epfd, events, MAX_EVENTS, -1);
+        if (ready < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            perror("epoll_wait");
+            break;
+        }
+
+        for (int i = 0; i < ready; i++)
+        {
+            uint32_t tag = events[i].data.u32;
+
+            if (tag == TAG_TIMER)
+            {
+                uint64_t expirations;
+                if (read(timer_fd, &expirations, sizeof(expirations)) > 0)
+                {
+                    for (size_t j = 0; j < session_count; j++)
+                        send_next_key(&sessions[j]);
+                }
+            }
+            else if (tag == TAG_SIGNAL)
+            {
+                struct signalfd_siginfo info;
+                while (read(signal_fd, &info, sizeof(info)) == sizeof(info))
+                {
+                    if (info.ssi_signo == SIGUSR1)
+                        print_stats();
+                    else
+                        running = 0;
+                }
+            }
+            else
+            {
+                read_session(epfd, &sessions[tag]);
+            }
+        }
+    }
+
+    print_stats();
+
+    for (size_t i = 0; i < session_count; i++)
+    {
+        if (sessions[i].log)
+            fclose(sessions[i].log);
+        if (sessions[i].hold_fd >= 0)
+            close(sessions[i].hold_fd);
+        close(sessions[i].fd);
+    }
+    free(sessions);
+    free(script);
+    return 0;
+}